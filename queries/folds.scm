@@ -0,0 +1,9 @@
+[
+  (list_literal)
+  (vector_literal)
+  (map_literal)
+  (set_literal)
+  (fn_literal)
+  (string)
+  (regex)
+] @fold
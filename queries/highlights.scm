@@ -0,0 +1,71 @@
+; Literals
+
+(comment) @comment
+
+(string) @string
+(regex) @string.regex
+(character) @character
+(number) @number
+(nil) @constant.builtin
+(boolean) @boolean
+(keyword) @string.special.symbol
+
+(invalid_character) @error
+(invalid_number) @error
+
+; Symbols in head position
+
+((list_literal
+  .
+  (symbol) @keyword)
+ (#any-of? @keyword
+  "def" "defn" "defn-" "defmacro" "defmulti" "defmethod" "defprotocol"
+  "defrecord" "deftype" "defonce" "ns" "fn" "fn*" "let" "letfn" "loop"
+  "recur" "if" "if-let" "if-not" "when" "when-let" "when-not" "cond"
+  "condp" "case" "do" "quote" "var" "throw" "try" "catch" "finally"
+  "new" "set!"))
+
+((fn_literal
+  .
+  (symbol) @keyword)
+ (#any-of? @keyword
+  "def" "defn" "defn-" "defmacro" "defmulti" "defmethod" "defprotocol"
+  "defrecord" "deftype" "defonce" "ns" "fn" "fn*" "let" "letfn" "loop"
+  "recur" "if" "if-let" "if-not" "when" "when-let" "when-not" "cond"
+  "condp" "case" "do" "quote" "var" "throw" "try" "catch" "finally"
+  "new" "set!"))
+
+(list_literal
+  .
+  (symbol) @function.call)
+
+(fn_literal
+  .
+  (symbol) @function.call)
+
+(tagged_literal
+  tag: (symbol) @tag)
+
+(symbol) @variable
+
+; Punctuation
+
+(marker) @punctuation.special
+(marker_splicing) @punctuation.special
+
+[
+  "#'"
+  "#_"
+  "#"
+] @punctuation.special
+
+[
+  "("
+  ")"
+  "["
+  "]"
+  "{"
+  "}"
+  "#{"
+  "#("
+] @punctuation.bracket
@@ -0,0 +1,107 @@
+; Namespaces
+
+((list_literal
+  .
+  (symbol) @_head
+  .
+  [
+    (symbol) @name
+    (with_metadata target: (symbol) @name)
+    (with_metadata target: (with_metadata target: (symbol) @name))
+  ]) @definition.module
+ (#eq? @_head "ns"))
+
+; Vars
+
+((list_literal
+  .
+  (symbol) @_head
+  .
+  [
+    (symbol) @name
+    (with_metadata target: (symbol) @name)
+    (with_metadata target: (with_metadata target: (symbol) @name))
+  ]) @definition.function
+ (#any-of? @_head "defn" "defn-" "defmulti"))
+
+((list_literal
+  .
+  (symbol) @_head
+  .
+  [
+    (symbol) @name
+    (with_metadata target: (symbol) @name)
+    (with_metadata target: (with_metadata target: (symbol) @name))
+  ]) @definition.macro
+ (#eq? @_head "defmacro"))
+
+((list_literal
+  .
+  (symbol) @_head
+  .
+  [
+    (symbol) @name
+    (with_metadata target: (symbol) @name)
+    (with_metadata target: (with_metadata target: (symbol) @name))
+  ]) @definition.constant
+ (#any-of? @_head "def" "defonce"))
+
+((list_literal
+  .
+  (symbol) @_head
+  .
+  [
+    (symbol) @name
+    (with_metadata target: (symbol) @name)
+    (with_metadata target: (with_metadata target: (symbol) @name))
+  ]) @definition.interface
+ (#eq? @_head "defprotocol"))
+
+((list_literal
+  .
+  (symbol) @_head
+  .
+  [
+    (symbol) @name
+    (with_metadata target: (symbol) @name)
+    (with_metadata target: (with_metadata target: (symbol) @name))
+  ]) @definition.class
+ (#any-of? @_head "defrecord" "deftype"))
+
+; References
+
+((list_literal
+  .
+  (symbol) @_head
+  (list_literal
+    .
+    (keyword) @_clause
+    [
+      (symbol) @name
+      (vector_literal . (symbol) @name)
+    ] @reference.module))
+ (#eq? @_head "ns")
+ (#any-of? @_clause ":require" ":require-macros" ":use"))
+
+; Special forms and def macros are not calls; same heads as
+; highlights.scm
+
+((list_literal
+  .
+  (symbol) @name) @reference.call
+ (#not-any-of? @name
+  "def" "defn" "defn-" "defmacro" "defmulti" "defmethod" "defprotocol"
+  "defrecord" "deftype" "defonce" "ns" "fn" "fn*" "let" "letfn" "loop"
+  "recur" "if" "if-let" "if-not" "when" "when-let" "when-not" "cond"
+  "condp" "case" "do" "quote" "var" "throw" "try" "catch" "finally"
+  "new" "set!"))
+
+((fn_literal
+  .
+  (symbol) @name) @reference.call
+ (#not-any-of? @name
+  "def" "defn" "defn-" "defmacro" "defmulti" "defmethod" "defprotocol"
+  "defrecord" "deftype" "defonce" "ns" "fn" "fn*" "let" "letfn" "loop"
+  "recur" "if" "if-let" "if-not" "when" "when-let" "when-not" "cond"
+  "condp" "case" "do" "quote" "var" "throw" "try" "catch" "finally"
+  "new" "set!"))
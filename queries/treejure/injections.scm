@@ -0,0 +1,11 @@
+; Regex literals: #"..."
+;
+; Neovim only: `#offset!` drops the `#"` prefix and the closing `"`, and
+; Neovim loads queries from queries/<lang>/. The tree-sitter CLI and
+; highlight library ignore `#offset!` and would hand the whole token to
+; the regex grammar, so this file is not registered in tree-sitter.json
+; until `regex` exposes its pattern body as a child node.
+
+((regex) @injection.content
+ (#offset! @injection.content 0 2 0 -1)
+ (#set! injection.language "regex"))
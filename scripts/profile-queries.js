@@ -0,0 +1,196 @@
+#!/usr/bin/env node
+// Per-pattern profiler for query files (queries/*.scm).
+//
+// Splits a query into its top-level patterns and runs each one alone with
+// `tree-sitter query` over a corpus, so time and matches can be attributed
+// to individual patterns. Each pattern's time is the median of several runs
+// minus a baseline query that only matches the root node, which removes
+// parsing and process start-up. Match attempts are estimated by counting,
+// in one `tree-sitter parse` pass, the corpus nodes of the kinds the
+// pattern is rooted at: the query engine tries a pattern at every such node.
+// Anonymous tokens do not appear in that output and are reported as '?'.
+//
+// Usage: node scripts/profile-queries.js [--runs N] [--top N] <query.scm> <files...>
+// Set TREE_SITTER to use a CLI other than the `tree-sitter` on PATH.
+
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const { spawnSync } = require('child_process');
+
+const TREE_SITTER = process.env.TREE_SITTER || 'tree-sitter';
+
+function usage() {
+  console.error('usage: profile-queries.js [--runs N] [--top N] <query.scm> <files...>');
+  process.exit(2);
+}
+
+function parseArgs(argv) {
+  const opts = { runs: 3, top: 10, query: null, files: [] };
+  for (let i = 0; i < argv.length; i++) {
+    if (argv[i] === '--runs') opts.runs = parseInt(argv[++i], 10);
+    else if (argv[i] === '--top') opts.top = parseInt(argv[++i], 10);
+    else if (!opts.query) opts.query = argv[i];
+    else opts.files.push(argv[i]);
+  }
+  if (!opts.query || opts.files.length === 0 || !(opts.runs > 0) || !(opts.top > 0)) usage();
+  return opts;
+}
+
+// Splits query source into top-level patterns. A pattern starts at depth 0
+// with '(', '[' or a string, and extends to the start of the next one, so
+// trailing captures, quantifiers and predicates stay with it. Comments are
+// dropped.
+function splitPatterns(source) {
+  const patterns = [];
+  let current = '';
+  let depth = 0;
+  for (let i = 0; i < source.length; i++) {
+    const c = source[i];
+    if (c === ';') {
+      while (i < source.length && source[i] !== '\n') i++;
+      current += '\n';
+      continue;
+    }
+    if (depth === 0 && (c === '(' || c === '[' || c === '"') && current.trim()) {
+      patterns.push(current.trim());
+      current = '';
+    }
+    if (c === '"') {
+      let j = i + 1;
+      while (j < source.length && source[j] !== '"') j += source[j] === '\\' ? 2 : 1;
+      current += source.slice(i, j + 1);
+      i = j;
+      continue;
+    }
+    if (c === '(' || c === '[') depth++;
+    else if (c === ')' || c === ']') depth--;
+    current += c;
+  }
+  if (current.trim()) patterns.push(current.trim());
+  return patterns;
+}
+
+// Node kinds a pattern is rooted at: the first named node, or every
+// top-level alternative of a root '[...]'. Anonymous roots keep their quotes.
+function rootKinds(pattern) {
+  const body = pattern.replace(/^\(+/, '');
+  if (pattern.startsWith('"')) return [pattern.match(/^"((?:[^"\\]|\\.)*)"/)[0]];
+  if (!body.startsWith('[')) {
+    const m = body.match(/^[A-Za-z_][\w.]*|^_/);
+    return m ? [m[0]] : ['_'];
+  }
+  const kinds = [];
+  let depth = 0;
+  for (let i = 0; i < body.length; i++) {
+    const c = body[i];
+    if (c === '[' || c === '(') {
+      depth++;
+      if (depth === 2 && c === '(') {
+        const m = body.slice(i + 1).match(/^[A-Za-z_][\w.]*/);
+        if (m) kinds.push(m[0]);
+      }
+    } else if (c === ']' || c === ')') {
+      if (--depth === 0) break;
+    } else if (c === '"' && depth === 1) {
+      const m = body.slice(i).match(/^"((?:[^"\\]|\\.)*)"/);
+      kinds.push(m[0]);
+      i += m[0].length - 1;
+    }
+  }
+  return kinds;
+}
+
+function run(args) {
+  const start = process.hrtime.bigint();
+  const result = spawnSync(TREE_SITTER, args, { encoding: 'utf8', maxBuffer: 1 << 30 });
+  const ms = Number(process.hrtime.bigint() - start) / 1e6;
+  if (result.error) throw result.error;
+  if (result.status !== 0) {
+    throw new Error(`${TREE_SITTER} ${args[0]} failed:\n${result.stderr}`);
+  }
+  return { ms, stdout: result.stdout };
+}
+
+function median(values) {
+  const sorted = [...values].sort((a, b) => a - b);
+  return sorted[Math.floor(sorted.length / 2)];
+}
+
+function timeQuery(file, files, runs) {
+  const times = [];
+  let stdout = '';
+  for (let r = 0; r < runs; r++) {
+    const result = run(['query', file, ...files]);
+    times.push(result.ms);
+    stdout = result.stdout;
+  }
+  return { ms: median(times), stdout };
+}
+
+// Node kind histogram of the corpus, from the S-expressions of `tree-sitter parse`
+function corpusKinds(files) {
+  const counts = new Map();
+  const { stdout } = run(['parse', ...files]);
+  for (const m of stdout.matchAll(/\((\w+)/g)) {
+    counts.set(m[1], (counts.get(m[1]) || 0) + 1);
+  }
+  return counts;
+}
+
+function kindCount(kinds, totalNodes, kind) {
+  if (kind === '_') return totalNodes;
+  if (kind.startsWith('"')) return null;
+  return kinds.get(kind) || 0;
+}
+
+function main() {
+  const opts = parseArgs(process.argv.slice(2));
+  const patterns = splitPatterns(fs.readFileSync(opts.query, 'utf8'));
+  const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'profile-queries-'));
+
+  try {
+    const baselineFile = path.join(dir, 'baseline.scm');
+    fs.writeFileSync(baselineFile, '(source) @root\n');
+    const baseline = timeQuery(baselineFile, opts.files, opts.runs).ms;
+    const kinds = corpusKinds(opts.files);
+    const totalNodes = [...kinds.values()].reduce((a, b) => a + b, 0);
+
+    const rows = patterns.map((pattern, index) => {
+      const file = path.join(dir, `pattern-${index}.scm`);
+      fs.writeFileSync(file, pattern + '\n');
+      const { ms, stdout } = timeQuery(file, opts.files, opts.runs);
+      const captures = new Map();
+      for (const m of stdout.matchAll(/capture: (?:\d+ - )?([\w.]+)/g)) {
+        captures.set(m[1], (captures.get(m[1]) || 0) + 1);
+      }
+      const roots = rootKinds(pattern);
+      const counts = roots.map(kind => kindCount(kinds, totalNodes, kind));
+      const attempts = counts.includes(null) ? '?' : counts.reduce((a, b) => a + b, 0);
+      return {
+        index,
+        line: pattern.replace(/\s+/g, ' ').slice(0, 72),
+        ms: Math.max(0, ms - baseline),
+        matches: (stdout.match(/^\s*pattern: /gm) || []).length,
+        attempts,
+        scanned: roots.map((kind, i) => `${kind}=${counts[i] === null ? '?' : counts[i]}`),
+        captures,
+      };
+    });
+
+    rows.sort((a, b) => b.ms - a.ms);
+    console.log(`${opts.query}: ${patterns.length} patterns, ${opts.files.length} files, ` +
+                `baseline ${baseline.toFixed(1)} ms (median of ${opts.runs})`);
+    for (const row of rows.slice(0, opts.top)) {
+      const scanned = row.scanned.join(' ');
+      const captured = [...row.captures].map(([name, n]) => `@${name}=${n}`).join(' ');
+      console.log(`#${row.index}\t${row.ms.toFixed(1)} ms\t${row.matches} matches\t` +
+                  `${row.attempts} attempts\t${row.line}`);
+      console.log(`\tscans: ${scanned || '-'}\tcaptures: ${captured || '-'}`);
+    }
+  } finally {
+    fs.rmSync(dir, { recursive: true, force: true });
+  }
+}
+
+main();
@@ -1,7 +1,4 @@
 #include "tree_sitter/parser.h"
-#include <wctype.h>
-#include <ctype.h>
-#include <string.h>
 
 enum TokenType {
   NUMBER, SYMBOL, KEYWORD,
@@ -16,13 +13,32 @@ enum TokenType {
 };
 
 static bool is_clojure_whitespace(int32_t c) {
-  return c == ' '  || c == '\t' || c == '\r' || c == '\n' || 
-         c == ','  || c == '\f' || c == '\v' ||
-         c == 0xA0 || c == 0xAD || (c >= 0x2000 && c <= 0x200A) || 
+  if (c < 0x80) {
+    return c == ' '  || c == '\t' || c == '\r' || c == '\n' ||
+           c == ','  || c == '\f' || c == '\v';
+  }
+  return c == 0xA0 || c == 0xAD || (c >= 0x2000 && c <= 0x200A) || 
          c == 0x2028 || c == 0x2029 || c == 0x202F || c == 0x205F || 
          c == 0x3000 || c == 0x1680 || c == 0x180E;
 }
 
+/**
+ * ASCII-only classifiers. <ctype.h> is undefined for code points above
+ * 0xFF and <wctype.h> depends on the locale, while the reader only
+ * accepts ASCII digits in numbers and character escapes.
+ */
+static bool is_ascii_digit(int32_t c) {
+  return c >= '0' && c <= '9';
+}
+
+static bool is_ascii_hex_digit(int32_t c) {
+  return is_ascii_digit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+static bool is_ascii_alnum(int32_t c) {
+  return is_ascii_digit(c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
 /**
  * Mirroring LispReader.isMacro(ch)
  */
@@ -67,8 +83,8 @@ static bool finish_number(TSLexer *lexer, bool has_digits) {
   while (!is_number_end(lexer->lookahead)) {
     int32_t c = lexer->lookahead;
 
-    if (isdigit(c)) { has_digits = true; }
-    else if (is_hex && isxdigit(c)) { has_digits = true; }
+    if (is_ascii_digit(c)) { has_digits = true; }
+    else if (is_hex && is_ascii_hex_digit(c)) { has_digits = true; }
     else if (c == '.' && !is_hex && !is_ratio && !is_float) is_float = true;
     else if (c == '/' && !is_hex && !is_float && !is_ratio) is_ratio = true;
     else if ((c == 'e' || c == 'E') && !is_hex && !is_ratio) {
@@ -77,7 +93,7 @@ static bool finish_number(TSLexer *lexer, bool has_digits) {
       continue;
     }
     else if ((c == 'r' || c == 'R') && has_digits && !is_radix && !is_float && !is_ratio && !is_hex) is_radix = true;
-    else if (is_radix && iswalnum(c)) has_digits = true;
+    else if (is_radix && is_ascii_alnum(c)) has_digits = true;
     else if ((c == 'N' || c == 'M') && has_digits) {
       lexer->advance(lexer, false);
       if (is_number_end(lexer->lookahead)) {
@@ -102,28 +118,44 @@ number_error:
   return true;
 }
 
+static bool name_equals(const int32_t *buffer, int len, const char *word) {
+  for (int i = 0; i < len; i++) {
+    if (word[i] == '\0' || buffer[i] != word[i]) return false;
+  }
+  return word[len] == '\0';
+}
+
 static int scan_character_type(TSLexer *lexer) {
   lexer->advance(lexer, false); // Consume "\" 
   if (lexer->lookahead == 0) return ERRONEOUS_CHARACTER;
   
-  char buffer[32]; int i = 0;
-  buffer[i++] = (char)lexer->lookahead; 
+  // Whole code points, so that non-ASCII input (e.g. decoded from UTF-16)
+  // can never alias an ASCII name or hex digit by truncation.
+  int32_t buffer[32]; int i = 0;
+  buffer[i++] = lexer->lookahead; 
   lexer->advance(lexer, false);
 
-  if (is_token_end(lexer->lookahead)) return CHARACTER_EXTERNAL;
+  // The JVM reader sees a code point above U+FFFF as a surrogate pair
+  // and rejects it as an unsupported character
+  if (is_token_end(lexer->lookahead)) {
+    return buffer[0] > 0xFFFF ? ERRONEOUS_CHARACTER : CHARACTER_EXTERNAL;
+  }
 
-  while (!is_token_end(lexer->lookahead) && i < 31) {
-    buffer[i++] = (char)lexer->lookahead;
+  // Consume the whole name even past the buffer so the token ends where
+  // the reader would stop; anything that long is not a valid name.
+  while (!is_token_end(lexer->lookahead)) {
+    if (i < 32) buffer[i] = lexer->lookahead;
+    i++;
     lexer->advance(lexer, false);
   }
-  buffer[i] = '\0';
+  if (i > 32) return ERRONEOUS_CHARACTER;
 
-  if (strcmp(buffer, "newline") == 0 || strcmp(buffer, "space") == 0 ||
-      strcmp(buffer, "tab") == 0 || strcmp(buffer, "formfeed") == 0 ||
-      strcmp(buffer, "backspace") == 0 || strcmp(buffer, "return") == 0) return CHARACTER_EXTERNAL;
+  if (name_equals(buffer, i, "newline") || name_equals(buffer, i, "space") ||
+      name_equals(buffer, i, "tab") || name_equals(buffer, i, "formfeed") ||
+      name_equals(buffer, i, "backspace") || name_equals(buffer, i, "return")) return CHARACTER_EXTERNAL;
 
   if (i == 5 && buffer[0] == 'u') {
-    for (int j = 1; j < 5; j++) if (!isxdigit(buffer[j])) return ERRONEOUS_CHARACTER;
+    for (int j = 1; j < 5; j++) if (!is_ascii_hex_digit(buffer[j])) return ERRONEOUS_CHARACTER;
     return CHARACTER_EXTERNAL;
   }
   if (buffer[0] == 'o' && i > 1 && i < 5) {
@@ -133,16 +165,63 @@ static int scan_character_type(TSLexer *lexer) {
   return ERRONEOUS_CHARACTER;
 }
 
+/**
+ * Mirroring LispReader.matchSymbol(s), validated in the same pass that
+ * finds the token end. The body is the token without the leading ':' or
+ * '::' of a keyword; `char_count` chars of it (or of the keyword colons)
+ * were already consumed by the caller and contain neither ':' nor '/'.
+ *
+ * body := (ns '/')? name, with name '/' or free of '/', ns non-empty
+ * and not starting with '/', and a name after ns not starting with a
+ * digit. Neither ns nor name may end with ':', and
+ * "::" may only appear as the auto-resolve prefix of a keyword. The bare
+ * "/" name is not accepted after that prefix: symbolPat has no match
+ * for "::/".
+ */
 static bool scan_identifier(TSLexer *lexer, int char_count, int result_type) {
+  bool is_keyword = result_type == KEYWORD;
+  bool auto_resolved = is_keyword && char_count == 2;
+  int body_len = is_keyword ? 0 : char_count;
+  int32_t prev = is_keyword ? ':' : 0;
+  bool starts_with_slash = false, double_colon = false;
+  int slash_at = -1, prev_slash_at = -1;
+  int32_t before_slash = 0, before_prev_slash = 0, after_slash = 0;
+
   while (!is_token_end(lexer->lookahead)) {
+    int32_t c = lexer->lookahead;
+    if (c == ':' && prev == ':') double_colon = true;
+    if (slash_at != -1 && body_len == slash_at + 1) after_slash = c;
+    if (c == '/') {
+      if (body_len == 0) starts_with_slash = true;
+      prev_slash_at = slash_at; before_prev_slash = before_slash;
+      slash_at = body_len; before_slash = prev;
+    }
+    prev = c;
+    body_len++;
     lexer->advance(lexer, false);
     char_count++;
   }
-  if (char_count > 0) {
-    lexer->result_symbol = result_type;
-    return true;
+  if (char_count == 0) return false;
+
+  int ns_len = -1; int32_t ns_last = 0; bool digit_name = false;
+  if (slash_at == -1 || (body_len == 1 && !auto_resolved)) {
+    // No namespace, or the bare "/" symbol
+  } else if (body_len == 1) {
+    ns_len = 0; // ::/
+  } else if (slash_at < body_len - 1) {
+    ns_len = slash_at; ns_last = before_slash;
+    digit_name = is_ascii_digit(after_slash);
+  } else if (prev_slash_at == body_len - 2) {
+    ns_len = prev_slash_at; ns_last = before_prev_slash; // ns//
+  } else {
+    ns_len = 0; // Empty name, e.g. a/ or ::ns/
   }
-  return false;
+
+  bool valid = body_len > 0 && !double_colon && prev != ':' && !digit_name &&
+               (ns_len == -1 || (ns_len > 0 && !starts_with_slash && ns_last != ':'));
+  if (valid) lexer->result_symbol = result_type;
+  else lexer->result_symbol = is_keyword ? ERRONEOUS_KEYWORD : ERRONEOUS_SYMBOL;
+  return true;
 }
 
 static int finish_string_content(TSLexer *lexer, int success_type) {
@@ -164,10 +243,11 @@ static int finish_string_content(TSLexer *lexer, int success_type) {
   return ERRONEOUS_STRING;
 }
 
-static bool scan_exact_word(TSLexer *lexer, const char *word, int len, int res) {
+static bool scan_exact_word(TSLexer *lexer, const char *word, int len, int res, int *consumed) {
   for (int i = 0; i < len; i++) {
     if (lexer->lookahead != word[i]) return false;
     lexer->advance(lexer, false);
+    (*consumed)++;
   }
   if (is_token_end(lexer->lookahead)) { lexer->result_symbol = res; return true; }
   return false;
@@ -220,9 +300,11 @@ bool tree_sitter_treejure_external_scanner_scan(void *payload, TSLexer *lexer, c
   if (first == '@' && valid_symbols[DEREF_MARKER]) { lexer->advance(lexer, false); lexer->result_symbol = DEREF_MARKER; return true; }
   if (first == '^' && valid_symbols[META_MARKER]) { lexer->advance(lexer, false); lexer->result_symbol = META_MARKER; return true; }
 
-  if (first == 'n' && valid_symbols[NIL_LITERAL] && scan_exact_word(lexer, "nil", 3, NIL_LITERAL)) return true;
-  if (first == 't' && valid_symbols[BOOL_TRUE] && scan_exact_word(lexer, "true", 4, BOOL_TRUE)) return true;
-  if (first == 'f' && valid_symbols[BOOL_FALSE] && scan_exact_word(lexer, "false", 5, BOOL_FALSE)) return true;
+  // Chars consumed by a failed nil/true/false match still belong to the symbol
+  int consumed = 0;
+  if (first == 'n' && valid_symbols[NIL_LITERAL] && scan_exact_word(lexer, "nil", 3, NIL_LITERAL, &consumed)) return true;
+  if (first == 't' && valid_symbols[BOOL_TRUE] && scan_exact_word(lexer, "true", 4, BOOL_TRUE, &consumed)) return true;
+  if (first == 'f' && valid_symbols[BOOL_FALSE] && scan_exact_word(lexer, "false", 5, BOOL_FALSE, &consumed)) return true;
 
   if (first == ':' && valid_symbols[KEYWORD]) {
     lexer->advance(lexer, false); int c = 1;
@@ -231,15 +313,15 @@ bool tree_sitter_treejure_external_scanner_scan(void *payload, TSLexer *lexer, c
   }
   if (first == '+' || first == '-') {
     lexer->advance(lexer, false);
-    if (isdigit(lexer->lookahead) && valid_symbols[NUMBER] && finish_number(lexer, true)) return true;
+    if (is_ascii_digit(lexer->lookahead) && valid_symbols[NUMBER] && finish_number(lexer, true)) return true;
     if (valid_symbols[SYMBOL]) return scan_identifier(lexer, 1, SYMBOL);
     return false;
   }
-  if (isdigit(first) && (valid_symbols[NUMBER] || valid_symbols[ERRONEOUS_NUMBER])) {
+  if (is_ascii_digit(first) && (valid_symbols[NUMBER] || valid_symbols[ERRONEOUS_NUMBER])) {
     return finish_number(lexer, false);
   }
-  if (valid_symbols[SYMBOL] && !is_macro(first) && !isdigit(first)) {
-    return scan_identifier(lexer, 0, SYMBOL);
+  if (valid_symbols[SYMBOL] && !is_macro(first) && !is_ascii_digit(first)) {
+    return scan_identifier(lexer, consumed, SYMBOL);
   }
   return false;
 }